@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "HexGeometry.hpp"
+
+/**
+ * Microbenchmarks of the geometry kernels used by View::draw.
+ * Every kernel runs over grids from 10^2 to 10^6 cells and the results
+ * are printed on stdout as a single JSON document.
+ */
+#ifndef WAVE_MICROBENCH_COMPILER
+#define WAVE_MICROBENCH_COMPILER ""
+#endif
+#ifndef WAVE_MICROBENCH_BUILD_TYPE
+#define WAVE_MICROBENCH_BUILD_TYPE ""
+#endif
+#ifndef WAVE_MICROBENCH_CXX_FLAGS
+#define WAVE_MICROBENCH_CXX_FLAGS ""
+#endif
+
+namespace {
+    constexpr float kCenterX = 960.0f;
+    constexpr float kCenterY = 540.0f;
+    constexpr float kAlpha = static_cast<float>(M_PI / 4);
+    constexpr float kRotation = 0.3f;
+    constexpr int kHexRadius = 30;
+    constexpr int kMinRepetitions = 5;
+    constexpr double kMinKernelSeconds = 0.2;
+
+    /**
+     * Keeps the compiler from optimizing the kernels away.
+     */
+    volatile float g_sink = 0.0f;
+
+    struct Result {
+        std::string kernel;
+        int gridSize;
+        size_t cells;
+        int repetitions;
+        double bestNs;
+        double medianNs;
+    };
+
+    /**
+     * @brief Smallest number of rings whose grid holds at least the requested number of cells.
+     */
+    int ringsForCells(size_t cells) {
+        int rings = 0;
+        while (static_cast<size_t>(3 * rings * (rings + 1) + 1) < cells) {
+            rings++;
+        }
+        return rings;
+    }
+
+    /**
+     * @brief Time a kernel until both kMinRepetitions and kMinKernelSeconds are reached.
+     *
+     * @param setup Called before every repetition, not timed.
+     * @param kernelBody The timed body.
+     */
+    Result measure(const std::string & kernel, int gridSize, size_t cells, const std::function<void()> & setup, const std::function<void()> & kernelBody) {
+        using Clock = std::chrono::steady_clock;
+        std::vector<double> samples;
+        double total = 0.0;
+        while (static_cast<int>(samples.size()) < kMinRepetitions || total < kMinKernelSeconds) {
+            setup();
+            const auto start = Clock::now();
+            kernelBody();
+            const auto end = Clock::now();
+            const double seconds = std::chrono::duration<double>(end - start).count();
+            samples.push_back(seconds * 1e9);
+            total += seconds;
+        }
+        std::sort(samples.begin(), samples.end());
+        return {kernel, gridSize, cells, static_cast<int>(samples.size()), samples.front(), samples[samples.size() / 2]};
+    }
+
+    void printJson(const std::vector<Result> & results) {
+        std::printf("{\n  \"benchmark\": \"wave_microbench\",\n");
+        std::printf("  \"compiler\": \"%s\",\n", WAVE_MICROBENCH_COMPILER);
+        std::printf("  \"build_type\": \"%s\",\n", WAVE_MICROBENCH_BUILD_TYPE);
+        std::printf("  \"cxx_flags\": \"%s\",\n", WAVE_MICROBENCH_CXX_FLAGS);
+        std::printf("  \"results\": [\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result & r = results[i];
+            std::printf("    {\"kernel\": \"%s\", \"grid_size\": %d, \"cells\": %zu, \"repetitions\": %d, "
+                        "\"best_ns\": %.0f, \"median_ns\": %.0f, \"median_ns_per_cell\": %.3f}%s\n",
+                        r.kernel.c_str(), r.gridSize, r.cells, r.repetitions,
+                        r.bestNs, r.medianNs, r.medianNs / r.cells,
+                        i + 1 < results.size() ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const float sinAlpha = std::sin(kAlpha);
+    std::vector<Result> results;
+
+    for (size_t target = 100; target <= 1000000; target *= 10) {
+        const int gridSize = ringsForCells(target);
+        std::vector<std::pair<int, int>> hexagones;
+        HexGeometry::layoutRings(kCenterX, kCenterY, gridSize, kRotation, sinAlpha, kHexRadius, hexagones);
+        const size_t cells = hexagones.size();
+
+        // Projected vertices shared by the visibility and thick line kernels.
+        std::vector<float> vertexX(cells * 6), vertexY(cells * 6);
+        for (size_t c = 0; c < cells; c++) {
+            HexGeometry::projectHexagon(hexagones[c].first, hexagones[c].second, sinAlpha, kRotation, kHexRadius, &vertexX[c * 6], &vertexY[c * 6]);
+        }
+
+        // 1. Ring layout (_drawGrid)
+        std::vector<std::pair<int, int>> layout;
+        results.push_back(measure("layout_rings", gridSize, cells, []{}, [&]{
+            HexGeometry::layoutRings(kCenterX, kCenterY, gridSize, kRotation, sinAlpha, kHexRadius, layout);
+            g_sink = g_sink + layout.back().first;
+        }));
+
+        // 2. Per-hex vertex projection (_draw3DHexagon)
+        std::vector<float> projX(cells * 6), projY(cells * 6);
+        results.push_back(measure("project_hexagon", gridSize, cells, []{}, [&]{
+            for (size_t c = 0; c < cells; c++) {
+                HexGeometry::projectHexagon(hexagones[c].first, hexagones[c].second, sinAlpha, kRotation, kHexRadius, &projX[c * 6], &projY[c * 6]);
+            }
+            g_sink = g_sink + projX.back() + projY.back();
+        }));
+
+        // 3. Face visibility over the whole batch
+        std::vector<char> visible(cells * 6);
+        results.push_back(measure("face_visibility", gridSize, cells, []{}, [&]{
+            for (size_t c = 0; c < cells; c++) {
+                bool faceVisible[6];
+                HexGeometry::computeFaceVisibility(&vertexY[c * 6], hexagones[c].second, faceVisible);
+                std::copy(faceVisible, faceVisible + 6, &visible[c * 6]);
+            }
+            g_sink = g_sink + visible.back();
+        }));
+
+        // 4. Depth sort, on a fresh copy of the unsorted layout every repetition
+        std::vector<std::pair<int, int>> toSort;
+        results.push_back(measure("depth_sort", gridSize, cells, [&]{ toSort = hexagones; }, [&]{
+            std::sort(toSort.begin(), toSort.end(), HexGeometry::compareSecondOfPair);
+            g_sink = g_sink + toSort.front().second;
+        }));
+
+        // 5. Thick line quads for the six top edges of every hexagon
+        results.push_back(measure("thick_line_quads", gridSize, cells, []{}, [&]{
+            float acc = 0.0f;
+            for (size_t c = 0; c < cells; c++) {
+                const float * vx = &vertexX[c * 6];
+                const float * vy = &vertexY[c * 6];
+                for (int i = 0; i < 6; i++) {
+                    const int next_i = (i + 1) % 6;
+                    float quadX[4], quadY[4];
+                    if (HexGeometry::thickLineQuad(vx[i], vy[i], vx[next_i], vy[next_i], 1, quadX, quadY)) {
+                        acc += quadX[2] + quadY[2];
+                    }
+                }
+            }
+            g_sink = g_sink + acc;
+        }));
+    }
+
+    printJson(results);
+    return 0;
+}
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "HexGeometry.hpp"
+
+namespace {
+    /**
+     * Axial coordinates of the six corners of the first ring, in the order used by layoutRings.
+     */
+    constexpr int kRingCorners[6][2] = {{1, 0}, {0, 1}, {-1, 1}, {-1, 0}, {0, -1}, {1, -1}};
+
+    /**
+     * Edge between two corners of a ring, precomputed once for all the hexagons on it.
+     */
+    struct RingEdge {
+        std::pair<int, int> start;
+        float normalX;
+        float normalY;
+        float distance;
+    };
+
+    /**
+     * Corner of the ring i at the given angle. The angle type is kept as is
+     * (float or double) so the rounding matches between all the callers.
+     */
+    template <typename Angle>
+    std::pair<int, int> ringCorner(const float x, const float y, const int gridRadius, const int i, const Angle angle, const float sinAlpha) {
+        return {(gridRadius * (i + 1)) * std::cos(angle) + x, (gridRadius * (i + 1)) * std::sin(angle) * sinAlpha + y};
+    }
+
+    /**
+     * Corner of the ring i preceding the first one, as computed by layoutRings.
+     */
+    std::pair<int, int> firstRingStart(const float x, const float y, const int gridRadius, const int i, const float rotation, const float sinAlpha) {
+        return ringCorner(x, y, gridRadius, i, 5 * M_PI / 3 + rotation + M_PI / 6, sinAlpha);
+    }
+
+    /**
+     * Corner j of the ring i, as computed by layoutRings.
+     */
+    std::pair<int, int> ringCornerAt(const float x, const float y, const int gridRadius, const int i, const int j, const float rotation, const float sinAlpha) {
+        const float angle = j * M_PI / 3 + rotation + M_PI / 6;
+        return ringCorner(x, y, gridRadius, i, angle, sinAlpha);
+    }
+
+    RingEdge makeRingEdge(const std::pair<int, int> & lastCoor, const std::pair<int, int> & currCoor) {
+        // longeur entre les deux points
+        float distance = std::sqrt(std::pow(currCoor.first - lastCoor.first, 2) + std::pow(currCoor.second - lastCoor.second, 2));
+        // la normale du vecteur
+        float normalX = (currCoor.first - lastCoor.first) / distance;
+        float normalY = (currCoor.second - lastCoor.second) / distance;
+        return {lastCoor, normalX, normalY, distance};
+    }
+
+    /**
+     * Hexagon k (between 1 and i) on an edge of the ring i.
+     */
+    std::pair<int, int> ringEdgePoint(const RingEdge & edge, const int i, const int k) {
+        return {static_cast<int>(edge.start.first + k * edge.normalX * edge.distance / (i + 1)),
+                static_cast<int>(edge.start.second + k * edge.normalY * edge.distance / (i + 1))};
+    }
+}
+
+void HexGeometry::layoutRings(const float x, const float y, const int gridSize, const float rotation, const float sinAlpha, const int hexRadius, std::vector<std::pair<int, int>> & hexagones) {
+    const int gridRadius = std::sqrt(3) * hexRadius;
+
+    hexagones.clear();
+    hexagones.reserve(3 * gridSize * (gridSize + 1) + 1);
+
+    // Rajoute l'hexagone central
+    hexagones.push_back({x, y});
+
+    // calcule le reste de la grille
+    for(int i = 0; i < gridSize; i++) {
+        // séparee en 6 ligne
+        std::pair<int, int> lastCoor = firstRingStart(x, y, gridRadius, i, rotation, sinAlpha);
+        for(int j = 0; j < 6; j++) {
+            std::pair<int, int> currCoor = ringCornerAt(x, y, gridRadius, i, j, rotation, sinAlpha);
+            hexagones.push_back(currCoor);
+            const RingEdge edge = makeRingEdge(lastCoor, currCoor);
+            // ajoute i hexagone entre les deux points
+            for(int k = 1; k < i + 1; k++) {
+                hexagones.push_back(ringEdgePoint(edge, i, k));
+            }
+            lastCoor = currCoor;
+        }
+    }
+}
+
+std::pair<int, int> HexGeometry::layoutPosition(const int q, const int r, const float x, const float y, const float rotation, const float sinAlpha, const int hexRadius) {
+    const int ring = axialDistance(q, r);
+    if (ring == 0) {
+        return {x, y};
+    }
+
+    const int gridRadius = std::sqrt(3) * hexRadius;
+    const int i = ring - 1;
+
+    // cherche le côté j de l'anneau (du coin j - 1 au coin j) qui contient la cellule
+    for (int j = 0; j < 6; j++) {
+        const int previous = (j + 5) % 6;
+        const int offsetQ = q - kRingCorners[previous][0] * ring;
+        const int offsetR = r - kRingCorners[previous][1] * ring;
+        const int stepQ = kRingCorners[j][0] - kRingCorners[previous][0];
+        const int stepR = kRingCorners[j][1] - kRingCorners[previous][1];
+        const int k = stepQ != 0 ? offsetQ / stepQ : offsetR / stepR;
+        if (k < 1 || k > ring || offsetQ != k * stepQ || offsetR != k * stepR) continue;
+
+        const std::pair<int, int> currCoor = ringCornerAt(x, y, gridRadius, i, j, rotation, sinAlpha);
+        if (k == ring) {
+            return currCoor;
+        }
+        const std::pair<int, int> lastCoor = j == 0 ? firstRingStart(x, y, gridRadius, i, rotation, sinAlpha)
+                                                    : ringCornerAt(x, y, gridRadius, i, previous, rotation, sinAlpha);
+        return ringEdgePoint(makeRingEdge(lastCoor, currCoor), i, k);
+    }
+    return {x, y};
+}
+
+void HexGeometry::layoutCellsInRange(const float minX, const float minY, const float maxX, const float maxY, const float x, const float y, const int gridSize, const float rotation, const float sinAlpha, const int hexRadius, std::vector<std::pair<int, int>> & hexagones) {
+    hexagones.clear();
+
+    // bornes axiales de la zone, depuis ses quatre coins (q et r sont linéaires dans le plan)
+    const float cornersX[4] = {minX, maxX, minX, maxX};
+    const float cornersY[4] = {minY, minY, maxY, maxY};
+    int minQ = gridSize, maxQ = -gridSize, minR = gridSize, maxR = -gridSize;
+    for (int c = 0; c < 4; c++) {
+        int q, r;
+        screenToAxial(cornersX[c], cornersY[c], x, y, rotation, sinAlpha, hexRadius, q, r);
+        minQ = std::min(minQ, q - 1);
+        maxQ = std::max(maxQ, q + 1);
+        minR = std::min(minR, r - 1);
+        maxR = std::max(maxR, r + 1);
+    }
+    minQ = std::max(minQ, -gridSize);
+    maxQ = std::min(maxQ, gridSize);
+    minR = std::max(minR, -gridSize);
+    maxR = std::min(maxR, gridSize);
+
+    for (int q = minQ; q <= maxQ; q++) {
+        for (int r = minR; r <= maxR; r++) {
+            if (axialDistance(q, r) > gridSize) continue;
+            const std::pair<int, int> position = layoutPosition(q, r, x, y, rotation, sinAlpha, hexRadius);
+            if (position.first < minX || position.first > maxX || position.second < minY || position.second > maxY) continue;
+            hexagones.push_back(position);
+        }
+    }
+}
+
+void HexGeometry::projectHexagon(const float x, const float y, const float sinAlpha, const float rotation, const int radius, float vertexX[6], float vertexY[6]) {
+    for (int i = 0; i < 6; i++) {
+        const float angle = i * M_PI / 3 + rotation;
+        vertexX[i] = radius * std::cos(angle) + x;
+        vertexY[i] = radius * std::sin(angle) * sinAlpha + y;
+    }
+}
+
+bool HexGeometry::isFaceIsometricallyVisible(float y1, float y2, float y) {
+    float faceY = (y1 + y2) / 2;
+    return faceY >= y;
+}
+
+void HexGeometry::computeFaceVisibility(const float vertexY[6], const float y, bool faceVisible[6]) {
+    for (int i = 0; i < 6; i++) {
+        const int next_i = (i + 1) % 6;
+        faceVisible[i] = isFaceIsometricallyVisible(vertexY[i], vertexY[next_i], y);
+    }
+}
+
+bool HexGeometry::compareSecondOfPair(const std::pair<int, int> & first, const std::pair<int, int> & second) {
+    // départage sur x pour que l'ordre du peintre ne dépende pas de l'ordre d'entrée
+    return first.second < second.second || (first.second == second.second && first.first < second.first);
+}
+
+bool HexGeometry::thickLineQuad(float x1, float y1, float x2, float y2, float thickness, float quadX[4], float quadY[4]) {
+    // Calculate direction vector
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float length = sqrtf(dx * dx + dy * dy);
+
+    // Handle zero-length lines
+    if (length == 0) return false;
+
+    // Normalize direction
+    dx /= length;
+    dy /= length;
+
+    // Calculate perpendicular vector (scaled by half-thickness)
+    float px = -dy * thickness / 2;
+    float py = dx * thickness / 2;
+
+    // Calculate four corners of the thick line
+    quadX[0] = x1 + px; quadY[0] = y1 + py; // P1: top-left
+    quadX[1] = x1 - px; quadY[1] = y1 - py; // P2: bottom-left
+    quadX[2] = x2 - px; quadY[2] = y2 - py; // P3: bottom-right
+    quadX[3] = x2 + px; quadY[3] = y2 + py; // P4: top-right
+    return true;
+}
+
+void HexGeometry::axialToScreen(const int q, const int r, const float x, const float y, const float rotation, const float sinAlpha, const int hexRadius, float & screenX, float & screenY) {
+    const int gridRadius = std::sqrt(3) * hexRadius;
+
+    // position dans le repère de la grille, non tourné
+    const float u = q * gridRadius * std::sqrt(3.0f) / 2;
+    const float v = q * gridRadius / 2.0f + r * gridRadius;
+
+    // rotation puis écrasement isométrique
+    const float cosRotation = std::cos(rotation);
+    const float sinRotation = std::sin(rotation);
+    screenX = u * cosRotation - v * sinRotation + x;
+    screenY = (u * sinRotation + v * cosRotation) * sinAlpha + y;
+}
+
+void HexGeometry::screenToAxial(const float screenX, const float screenY, const float x, const float y, const float rotation, const float sinAlpha, const int hexRadius, int & q, int & r) {
+    const int gridRadius = std::sqrt(3) * hexRadius;
+
+    // annule l'écrasement isométrique
+    const float dx = screenX - x;
+    const float dy = (screenY - y) / sinAlpha;
+
+    // annule la rotation
+    const float cosRotation = std::cos(rotation);
+    const float sinRotation = std::sin(rotation);
+    const float u = dx * cosRotation + dy * sinRotation;
+    const float v = -dx * sinRotation + dy * cosRotation;
+
+    // coordonnées axiales fractionnaires
+    const float fq = 2 * u / (gridRadius * std::sqrt(3.0f));
+    const float fr = v / gridRadius - fq / 2;
+    const float fs = -fq - fr;
+
+    // arrondi cubique : on corrige la coordonnée qui a le plus dévié
+    float rq = std::round(fq);
+    float rr = std::round(fr);
+    const float rs = std::round(fs);
+    const float diffQ = std::fabs(rq - fq);
+    const float diffR = std::fabs(rr - fr);
+    const float diffS = std::fabs(rs - fs);
+    if (diffQ > diffR && diffQ > diffS) {
+        rq = -rr - rs;
+    } else if (diffR > diffS) {
+        rr = -rq - rs;
+    }
+    q = static_cast<int>(rq);
+    r = static_cast<int>(rr);
+}
+
+int HexGeometry::axialDistance(const int q, const int r) {
+    return (std::abs(q) + std::abs(r) + std::abs(q + r)) / 2;
+}
+
+bool HexGeometry::isInsideHexPrism(const float pointX, const float pointY, const float vertexX[6], const float vertexY[6], const float height) {
+    // intervalle de la face supérieure coupé par la verticale passant par le point
+    bool crosses = false;
+    float minY = 0, maxY = 0;
+    for (int i = 0; i < 6; i++) {
+        const int next_i = (i + 1) % 6;
+        const float x1 = vertexX[i], x2 = vertexX[next_i];
+        if ((pointX < x1 && pointX < x2) || (pointX > x1 && pointX > x2) || x1 == x2) continue;
+
+        const float t = (pointX - x1) / (x2 - x1);
+        const float crossY = vertexY[i] + t * (vertexY[next_i] - vertexY[i]);
+        minY = crosses ? std::min(minY, crossY) : crossY;
+        maxY = crosses ? std::max(maxY, crossY) : crossY;
+        crosses = true;
+    }
+    return crosses && pointY >= minY && pointY <= maxY + height;
+}
+
+bool HexGeometry::pickHexagon(const float pointX, const float pointY, const float x, const float y, const int gridSize, const float rotation, const float sinAlpha, const int hexRadius, const float height, int & q, int & r) {
+    const int gridRadius = std::sqrt(3) * hexRadius;
+
+    // nombre d'échantillons le long du segment vertical, une demi-cellule par pas
+    const float worldLength = height / sinAlpha;
+    const int steps = static_cast<int>(std::ceil(worldLength / (gridRadius / 2.0f)));
+
+    // les cellules traversées par le segment et leurs voisines, car les faces
+    // supérieures débordent un peu de la cellule de Voronoï de leur centre
+    constexpr int neighbours[7][2] = {{0, 0}, {1, 0}, {0, 1}, {-1, 1}, {-1, 0}, {0, -1}, {1, -1}};
+    std::vector<std::pair<int, int>> candidates;
+    for (int step = 0; step <= steps; step++) {
+        const float sampleY = pointY - (steps > 0 ? height * step / steps : 0);
+        int sampleQ, sampleR;
+        screenToAxial(pointX, sampleY, x, y, rotation, sinAlpha, hexRadius, sampleQ, sampleR);
+        for (const auto & neighbour : neighbours) {
+            const std::pair<int, int> candidate = {sampleQ + neighbour[0], sampleR + neighbour[1]};
+            if (std::find(candidates.begin(), candidates.end(), candidate) == candidates.end()) {
+                candidates.push_back(candidate);
+            }
+        }
+    }
+
+    bool found = false;
+    std::pair<int, int> best = {0, 0};
+    for (const auto & candidate : candidates) {
+        if (axialDistance(candidate.first, candidate.second) > gridSize) continue;
+
+        // même position que celle où la grille est dessinée
+        const std::pair<int, int> center = layoutPosition(candidate.first, candidate.second, x, y, rotation, sinAlpha, hexRadius);
+        const float centerX = center.first;
+        const float centerY = center.second;
+
+        // l'ordre du peintre : la cellule la plus basse à l'écran est dessinée en dernier
+        if (found && !compareSecondOfPair(best, center)) continue;
+
+        float vertexX[6], vertexY[6];
+        projectHexagon(centerX, centerY, sinAlpha, rotation, hexRadius, vertexX, vertexY);
+        if (isInsideHexPrism(pointX, pointY, vertexX, vertexY, height)) {
+            found = true;
+            best = center;
+            q = candidate.first;
+            r = candidate.second;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <utility>
+#include <vector>
+
+/**
+ * Pure geometry kernels used by the View to lay out and project the grid.
+ * Nothing in here touches SDL, so it can be called (and benchmarked)
+ * without a window or a renderer.
+ */
+namespace HexGeometry {
+    /**
+     * @brief Compute the screen position of every hexagon of the grid, ring by ring.
+     *
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param gridSize The number of rings around the central hexagon.
+     * @param rotation The rotation of the grid.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param hexRadius The radius of a single hexagon.
+     * @param hexagones Output vector, cleared then filled with 3 * gridSize * (gridSize + 1) + 1 centers.
+     */
+    void layoutRings(const float x, const float y, const int gridSize, const float rotation, const float sinAlpha, const int hexRadius, std::vector<std::pair<int, int>> & hexagones);
+
+    /**
+     * @brief Screen position given by layoutRings to the cell at axial coordinates (q, r).
+     *
+     * Same arithmetic as layoutRings (truncations included) so a single cell can be
+     * found exactly where the full layout put it, without laying out the whole grid.
+     * The axial axes are the ones of axialToScreen.
+     *
+     * @param q The axial q coordinate of the cell.
+     * @param r The axial r coordinate of the cell.
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param rotation The rotation of the grid.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param hexRadius The radius of a single hexagon.
+     * @return The screen position of the center of the cell.
+     */
+    std::pair<int, int> layoutPosition(const int q, const int r, const float x, const float y, const float rotation, const float sinAlpha, const int hexRadius);
+
+    /**
+     * @brief Layout position of every cell of the grid whose center lies in a screen rectangle.
+     *
+     * Only the axial range covering the rectangle is visited, so the cost depends on the
+     * size of the rectangle and not on the size of the grid.
+     *
+     * @param minX The left of the rectangle.
+     * @param minY The top of the rectangle.
+     * @param maxX The right of the rectangle.
+     * @param maxY The bottom of the rectangle.
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param gridSize The number of rings around the central hexagon.
+     * @param rotation The rotation of the grid.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param hexRadius The radius of a single hexagon.
+     * @param hexagones Output vector, cleared then filled with the centers, in no particular order.
+     */
+    void layoutCellsInRange(const float minX, const float minY, const float maxX, const float maxY, const float x, const float y, const int gridSize, const float rotation, const float sinAlpha, const int hexRadius, std::vector<std::pair<int, int>> & hexagones);
+
+    /**
+     * @brief Project the six vertices of the top face of a hexagon.
+     *
+     * @param x The x-coordinate of the center of the hexagon.
+     * @param y The y-coordinate of the center of the hexagon.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param rotation The rotation of the grid.
+     * @param radius The radius of the hexagon.
+     * @param vertexX Output x-coordinates of the six vertices.
+     * @param vertexY Output y-coordinates of the six vertices.
+     */
+    void projectHexagon(const float x, const float y, const float sinAlpha, const float rotation, const int radius, float vertexX[6], float vertexY[6]);
+
+    /**
+     * @brief true if the face y1, y2 of the object place at y is visible
+     *
+     * @param y1 height of the first side of the face
+     * @param y2 height of the second side of the face
+     * @param y height if the centre of the object
+     * @return true the face is visible
+     * @return false the face is hide
+     */
+    bool isFaceIsometricallyVisible(float y1, float y2, float y);
+
+    /**
+     * @brief Compute the visibility of the six side faces of a projected hexagon.
+     *
+     * @param vertexY The y-coordinates of the six projected vertices.
+     * @param y The y-coordinate of the center of the hexagon.
+     * @param faceVisible Output, faceVisible[i] is the face between vertex i and i + 1.
+     */
+    void computeFaceVisibility(const float vertexY[6], const float y, bool faceVisible[6]);
+
+    /**
+     * @brief Compare the second element of two pairs.
+     *
+     * @param first The first pair to compare.
+     * @param second The second pair to compare.
+     * @return true if the second element of the first pair is less than the second element of the second pair,
+     *         ties being broken on the first element.
+     * @return false otherwise.
+     */
+    bool compareSecondOfPair(const std::pair<int, int> & first, const std::pair<int, int> & second);
+
+    /**
+     * @brief Compute the four corners of the quad covering a thick line.
+     *
+     * @param x1 The x-coordinate of the first point.
+     * @param y1 The y-coordinate of the first point.
+     * @param x2 The x-coordinate of the second point.
+     * @param y2 The y-coordinate of the second point.
+     * @param thickness The thickness of the line.
+     * @param quadX Output x-coordinates of the corners.
+     * @param quadY Output y-coordinates of the corners.
+     * @return false if the line has a zero length (the quad is left untouched).
+     */
+    bool thickLineQuad(float x1, float y1, float x2, float y2, float thickness, float quadX[4], float quadY[4]);
+
+    /**
+     * @brief Screen position of the center of the cell at axial coordinates (q, r).
+     *
+     * The axial axes follow the grid built by layoutRings: q points toward pi/6 + rotation
+     * and r toward pi/2 + rotation, one step being sqrt(3) * hexRadius (truncated like in layoutRings).
+     *
+     * @param q The axial q coordinate of the cell.
+     * @param r The axial r coordinate of the cell.
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param rotation The rotation of the grid.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param hexRadius The radius of a single hexagon.
+     * @param screenX Output x-coordinate of the center of the cell.
+     * @param screenY Output y-coordinate of the center of the cell.
+     */
+    void axialToScreen(const int q, const int r, const float x, const float y, const float rotation, const float sinAlpha, const int hexRadius, float & screenX, float & screenY);
+
+    /**
+     * @brief Cell whose top face contains the screen point, by inverting the projection.
+     *
+     * Undoes the sinAlpha vertical squash and the rotation, then rounds to the nearest axial cell.
+     *
+     * @param screenX The x-coordinate of the point.
+     * @param screenY The y-coordinate of the point.
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param rotation The rotation of the grid.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param hexRadius The radius of a single hexagon.
+     * @param q Output axial q coordinate.
+     * @param r Output axial r coordinate.
+     */
+    void screenToAxial(const float screenX, const float screenY, const float x, const float y, const float rotation, const float sinAlpha, const int hexRadius, int & q, int & r);
+
+    /**
+     * @brief Number of rings between the cell (q, r) and the central cell.
+     */
+    int axialDistance(const int q, const int r);
+
+    /**
+     * @brief true if the screen point is covered by the prism drawn for a hexagon.
+     *
+     * The prism is the top face swept down by height, which is a convex shape:
+     * the point is inside if the vertical line through it crosses the top face
+     * at most height pixels above it.
+     *
+     * @param pointX The x-coordinate of the point.
+     * @param pointY The y-coordinate of the point.
+     * @param vertexX The x-coordinates of the six projected vertices of the top face.
+     * @param vertexY The y-coordinates of the six projected vertices of the top face.
+     * @param height The height of the prism on screen.
+     * @return true the point is on the top face or on a side face.
+     * @return false otherwise.
+     */
+    bool isInsideHexPrism(const float pointX, const float pointY, const float vertexX[6], const float vertexY[6], const float height);
+
+    /**
+     * @brief Find the visible cell under a screen point.
+     *
+     * Only the cells crossed by the vertical segment between the point and height
+     * pixels above it can cover the point, so the cost depends on the view angle
+     * but not on the size of the grid. Candidates are placed with layoutPosition,
+     * where the grid is drawn, and the one drawn last in painter's order
+     * (compareSecondOfPair) wins.
+     *
+     * @param pointX The x-coordinate of the point.
+     * @param pointY The y-coordinate of the point.
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param gridSize The number of rings around the central hexagon.
+     * @param rotation The rotation of the grid.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param hexRadius The radius of a single hexagon.
+     * @param height The height of the prisms on screen.
+     * @param q Output axial q coordinate of the picked cell.
+     * @param r Output axial r coordinate of the picked cell.
+     * @return true if a cell of the grid is under the point.
+     * @return false if the point is outside of the grid.
+     */
+    bool pickHexagon(const float pointX, const float pointY, const float x, const float y, const int gridSize, const float rotation, const float sinAlpha, const int hexRadius, const float height, int & q, int & r);
+}
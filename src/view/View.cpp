@@ -5,6 +5,7 @@
 
 #include "View.hpp"
 #include "ViewConstants.hpp"
+#include "HexGeometry.hpp"
 
 View::View(Model & p_model):
     _Model(p_model),
@@ -12,7 +13,24 @@ View::View(Model & p_model):
     _renderer(nullptr),
     _event(),
     lastFrameTime(0),
-    frameDelay(1000 / ViewConstants::FRAME_RATE) {
+    frameDelay(1000 / ViewConstants::FRAME_RATE),
+    _mouseX(0),
+    _mouseY(0),
+    _isMousePositionKnown(false),
+    _isPickPending(false),
+    _isClickPending(false),
+    _isCellHovered(false),
+    _hoveredQ(0),
+    _hoveredR(0),
+    _isCellSelected(false),
+    _selectedQ(0),
+    _selectedR(0),
+    _frameTexture(nullptr),
+    _isPartialRedrawEnabled(false),
+    _isFullRedrawNeeded(true),
+    _lastIsoAlpha(0),
+    _lastRotation(0),
+    _lastGridSize(0) {
     // Initialize SDL
     if(SDL_Init(SDL_INIT_VIDEO) != 0){
         std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
@@ -29,16 +47,22 @@ View::View(Model & p_model):
     }
 
     // Create a renderer
-    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
     if(!_renderer){
         std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
         SDL_DestroyWindow(_window);
         SDL_Quit();
         throw std::runtime_error("Renderer creation failed");
     }
+
+    // Create the texture keeping the last frame, partial redraw is disabled without it
+    _createFrameTexture();
 }
 
 View::~View() {
+    if (_frameTexture) {
+        SDL_DestroyTexture(_frameTexture);
+    }
     SDL_DestroyRenderer(_renderer);
     SDL_DestroyWindow(_window);
     SDL_Quit();
@@ -54,16 +78,75 @@ bool View::input(void) {
                 break;
             case SDL_KEYDOWN:
                 shouldContinueRunning = _handleKeyPress(_event.key.keysym.sym, _deltaTime);
+                // the grid moved under the mouse
+                _isPickPending = _isPickPending || _isMousePositionKnown;
+                break;
+            case SDL_MOUSEMOTION:
+                _handleMouse(_event.motion.x, _event.motion.y, false);
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+                _handleMouse(_event.button.x, _event.button.y, _event.button.button == SDL_BUTTON_LEFT);
+                break;
+            case SDL_WINDOWEVENT:
+                if (_event.window.event == SDL_WINDOWEVENT_LEAVE) {
+                    _handleMouseLeave();
+                }
+                break;
+            case SDL_RENDER_TARGETS_RESET:
+                // the content of the last frame texture is lost
+                _isFullRedrawNeeded = true;
+                break;
+            case SDL_RENDER_DEVICE_RESET: {
+                // the last frame texture itself is lost, recreate it without overriding the P toggle
+                const bool wasPartialRedrawEnabled = _isPartialRedrawEnabled;
+                _createFrameTexture();
+                _isPartialRedrawEnabled = _isPartialRedrawEnabled && wasPartialRedrawEnabled;
+                break;
+            }
             default:
                 break;
         }
     }
+    // One pick per frame, whatever the number of mouse events received
+    if (_isPickPending) {
+        _pickCell();
+    }
     return shouldContinueRunning;
 }
 
 void View::draw(void) {
-    _drawBackground();
-    _drawGrid(ViewConstants::WINDOW_WIDTH / 2, ViewConstants::WINDOW_HEIGHT / 2);
+    constexpr float centerX = ViewConstants::WINDOW_WIDTH / 2;
+    constexpr float centerY = ViewConstants::WINDOW_HEIGHT / 2;
+
+    if (!_isPartialRedrawEnabled) {
+        _drawBackground();
+        _drawGrid(centerX, centerY);
+        _dirtyCells.clear();
+        SDL_RenderPresent(_renderer);
+        return;
+    }
+
+    // Update the last frame, entirely only if the whole grid moved
+    if (SDL_SetRenderTarget(_renderer, _frameTexture) != 0) {
+        std::cerr << "SDL_SetRenderTarget Error: " << SDL_GetError() << std::endl;
+        _isPartialRedrawEnabled = false;
+        _isFullRedrawNeeded = true;
+        draw();
+        return;
+    }
+    const bool hasViewChanged = _hasViewChanged();
+    if (_isFullRedrawNeeded || hasViewChanged) {
+        _drawBackground();
+        _drawGrid(centerX, centerY);
+    } else {
+        _drawDirtyCells(centerX, centerY);
+    }
+    _dirtyCells.clear();
+    _isFullRedrawNeeded = false;
+
+    // The backbuffer is undefined after a present, so the whole frame is copied back
+    SDL_SetRenderTarget(_renderer, nullptr);
+    SDL_RenderCopy(_renderer, _frameTexture, nullptr, nullptr);
     SDL_RenderPresent(_renderer);
 }
 
@@ -112,48 +195,109 @@ bool View::_handleKeyPress(SDL_Keycode keyCode, float deltaTime) {
         case SDLK_f:
             _Model.addGridSize(-1);
             break;
+        case SDLK_p:
+            _isPartialRedrawEnabled = !_isPartialRedrawEnabled && _frameTexture != nullptr;
+            _isFullRedrawNeeded = true;
+            break;
         default:
             break;
     }
     return true;
 }
 
+void View::_createFrameTexture(void) {
+    if (_frameTexture) {
+        SDL_DestroyTexture(_frameTexture);
+    }
+    _frameTexture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, ViewConstants::WINDOW_WIDTH, ViewConstants::WINDOW_HEIGHT);
+    if(!_frameTexture){
+        std::cerr << "SDL_CreateTexture Error: " << SDL_GetError() << std::endl;
+    }
+    _isPartialRedrawEnabled = _frameTexture != nullptr;
+    _isFullRedrawNeeded = true;
+}
+
+void View::_handleMouse(int x, int y, bool isClick) {
+    _mouseX = x;
+    _mouseY = y;
+    _isMousePositionKnown = true;
+    _isPickPending = true;
+    _isClickPending = _isClickPending || isClick;
+}
+
+void View::_handleMouseLeave(void) {
+    _isMousePositionKnown = false;
+    _isPickPending = false;
+    _isClickPending = false;
+    if (_isCellHovered) {
+        _dirtyCells.push_back({_hoveredQ, _hoveredR});
+        _isCellHovered = false;
+    }
+}
+
+void View::_pickCell(void) {
+    const bool wasCellHovered = _isCellHovered;
+    const bool wasCellSelected = _isCellSelected;
+    const std::pair<int, int> lastHovered = {_hoveredQ, _hoveredR};
+    const std::pair<int, int> lastSelected = {_selectedQ, _selectedR};
+
+    const float sinAlpha = std::sin(_Model.getIsoAlpha());
+    const float height = ViewConstants::HEX_RADIUS * 1.5f * std::cos(_Model.getIsoAlpha());
+    int q, r;
+    _isCellHovered = HexGeometry::pickHexagon(_mouseX, _mouseY,
+                                              ViewConstants::WINDOW_WIDTH / 2, ViewConstants::WINDOW_HEIGHT / 2,
+                                              _Model.getGridSize(), _Model.getRotation(), sinAlpha,
+                                              ViewConstants::HEX_RADIUS, height, q, r);
+    if (_isCellHovered) {
+        _hoveredQ = q;
+        _hoveredR = r;
+    }
+    if (_isClickPending) {
+        _isCellSelected = _isCellHovered;
+        _selectedQ = _hoveredQ;
+        _selectedR = _hoveredR;
+    }
+    _isPickPending = false;
+    _isClickPending = false;
+
+    // Redraw the cells whose top colour changed
+    if (wasCellHovered != _isCellHovered || lastHovered != std::make_pair(_hoveredQ, _hoveredR)) {
+        if (wasCellHovered) _dirtyCells.push_back(lastHovered);
+        if (_isCellHovered) _dirtyCells.push_back({_hoveredQ, _hoveredR});
+    }
+    if (wasCellSelected != _isCellSelected || lastSelected != std::make_pair(_selectedQ, _selectedR)) {
+        if (wasCellSelected) _dirtyCells.push_back(lastSelected);
+        if (_isCellSelected) _dirtyCells.push_back({_selectedQ, _selectedR});
+    }
+}
+
+bool View::_hasViewChanged(void) {
+    const bool hasChanged = _Model.getIsoAlpha() != _lastIsoAlpha
+                         || _Model.getRotation() != _lastRotation
+                         || _Model.getGridSize() != _lastGridSize;
+    _lastIsoAlpha = _Model.getIsoAlpha();
+    _lastRotation = _Model.getRotation();
+    _lastGridSize = _Model.getGridSize();
+    return hasChanged;
+}
+
 void View::_drawBackground(void){
     // Clear the renderer
-    SDL_SetRenderDrawColor(_renderer, 15, 131, 247, 255);
+    const SDL_Color color = ViewConstants::BACKGROUND_COLOR;
+    SDL_SetRenderDrawColor(_renderer, color.r, color.g, color.b, color.a);
     SDL_RenderClear(_renderer);
 }
 
 void View::_drawThickLine(float x1, float y1, float x2, float y2, float thickness, SDL_Color color) {
-    // Calculate direction vector
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float length = sqrtf(dx * dx + dy * dy);
-
-    // Handle zero-length lines
-    if (length == 0) return;
-
-    // Normalize direction
-    dx /= length;
-    dy /= length;
-
-    // Calculate perpendicular vector (scaled by half-thickness)
-    float px = -dy * thickness / 2;
-    float py = dx * thickness / 2;
-
-    // Calculate four corners of the thiccolork line
-    SDL_FPoint points[4] = {
-        { x1 + px, y1 + py }, // P1: top-left
-        { x1 - px, y1 - py }, // P2: bottom-left
-        { x2 - px, y2 - py }, // P3: bottom-right
-        { x2 + px, y2 + py }  // P4: top-right
-    };
+    // Calculate the four corners of the thick line (nothing to draw for zero-length lines)
+    float quadX[4], quadY[4];
+    if (!HexGeometry::thickLineQuad(x1, y1, x2, y2, thickness, quadX, quadY)) return;
 
     // Vertices for the quad (position + color)
     SDL_Vertex vertices[4];
     for (int i = 0; i < 4; ++i) {
         vertices[i] = (SDL_Vertex){
-            .position = points[i],
+            .position = { quadX[i], quadY[i] },
             .color = color,
             .tex_coord = { 0, 0 }
         };
@@ -214,25 +358,18 @@ void View::_drawThickRoundLine(float x1, float y1, float x2, float y2, float thi
     _fillCircle(x2, y2 - 1, thickness / 2.0f);
 }
 
-void View::_draw3DHexagon(const float x, const float y, const float alpha, const float sinAlpha, const float rotation, const int radius) {
+void View::_draw3DHexagon(const float x, const float y, const float alpha, const float sinAlpha, const float rotation, const int radius, const SDL_Color topColor) {
     // 1. Préparation des paramètres de base
     const float cosAlpha = std::cos(alpha);
     const float height = radius * 1.5f * cosAlpha;
 
     // 2. Calcul des sommets de l'hexagone supérieur
     float vertexX[6], vertexY[6];
-    for (int i = 0; i < 6; i++) {
-        const float angle = i * M_PI / 3 + rotation;
-        vertexX[i] = radius * std::cos(angle) + x;
-        vertexY[i] = radius * std::sin(angle) * sinAlpha + y;
-    }
+    HexGeometry::projectHexagon(x, y, sinAlpha, rotation, radius, vertexX, vertexY);
 
     // 3. Détection de visibilité des faces latérales
     bool faceVisible[6];
-    for (int i = 0; i < 6; i++) {
-        const int next_i = (i + 1) % 6;
-        faceVisible[i] = _isFaceIsometricallyVisible(vertexY[i], vertexY[next_i], y);
-    }
+    HexGeometry::computeFaceVisibility(vertexY, y, faceVisible);
 
     // 4. Dessin des faces latérales (premier plan arrière)
     for (int i = 0; i < 6; i++) {
@@ -262,7 +399,7 @@ void View::_draw3DHexagon(const float x, const float y, const float alpha, const
     // 5. Dessin de la face supérieure (plan intermédiaire)
     SDL_Vertex topVertices[6];
     for (int i = 0; i < 6; i++) {
-        topVertices[i] = {{vertexX[i], vertexY[i]}, {0, 200, 150, 255}, {0,0}};
+        topVertices[i] = {{vertexX[i], vertexY[i]}, topColor, {0,0}};
     }
     constexpr int topIndices[] = {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5};
     SDL_RenderGeometry(_renderer, nullptr, topVertices, 6, topIndices, 12);
@@ -331,51 +468,91 @@ void View::_drawGrid(const float x, const float y) {
     const float alpha = _Model.getIsoAlpha();
     const float rotation = _Model.getRotation();
     const int gridSize = _Model.getGridSize();
-    constexpr int hexRadius = 30;
+    constexpr int hexRadius = ViewConstants::HEX_RADIUS;
     std::vector<std::pair<int, int>> hexagones;
 
     // 2. précalculation
     const float sinAlpha = std::sin(alpha);
-    const int gridRadius =std::sqrt(3) * hexRadius;
-
-    // 3. Rajoute l'hexagone central
-    hexagones.push_back({x, y});
-
-    // 4. calcule le reste de la grille
-    for(int i = 0; i < gridSize; i++) {
-        // séparee en 6 ligne
-        std::pair<int, int> lastCoor = {(gridRadius * (i + 1)) * std::cos(5 * M_PI / 3 + rotation + M_PI / 6) + x, (gridRadius * (i + 1)) * std::sin(5 * M_PI / 3 + rotation + M_PI / 6) * sinAlpha + y};
-        for(int j = 0; j < 6; j++) {
-            const float angle = j * M_PI / 3 + rotation + M_PI / 6;
-            std::pair<int, int> currCoor = {(gridRadius * (i + 1)) * std::cos(angle) + x, (gridRadius * (i + 1)) * std::sin(angle) * sinAlpha + y};
-            hexagones.push_back(currCoor);
-            // longeur entre les deux points
-            float distance = std::sqrt(std::pow(currCoor.first - lastCoor.first, 2) + std::pow(currCoor.second - lastCoor.second, 2));
-            // la normale du vecteur
-            float normalX = (currCoor.first - lastCoor.first) / distance;
-            float normalY = (currCoor.second - lastCoor.second) / distance;
-            // ajoute i hexagone entre les deux points
-            for(int k = 1; k < i + 1; k++) {
-                std::pair<int, int> newCoor = {static_cast<int>(lastCoor.first + k * normalX * distance / (i + 1)),
-                                               static_cast<int>(lastCoor.second + k * normalY * distance / (i + 1))};
-                hexagones.push_back(newCoor);
+
+    // 3. calcule la position de chaque hexagone de la grille
+    HexGeometry::layoutRings(x, y, gridSize, rotation, sinAlpha, hexRadius, hexagones);
+
+    std::sort(hexagones.begin(), hexagones.end(), HexGeometry::compareSecondOfPair);
+
+    _drawHexagons(hexagones, x, y, alpha, sinAlpha, rotation);
+}
+
+void View::_drawDirtyCells(const float x, const float y) {
+    // 1. prépare les variable
+    const float alpha = _Model.getIsoAlpha();
+    const float rotation = _Model.getRotation();
+    const int gridSize = _Model.getGridSize();
+    constexpr int hexRadius = ViewConstants::HEX_RADIUS;
+    constexpr int margin = ViewConstants::DIRTY_RECT_MARGIN;
+    const float sinAlpha = std::sin(alpha);
+    const float height = hexRadius * 1.5f * std::cos(alpha);
+
+    // 2. rectangle couvrant le prisme de chaque cellule modifiée, fusionnés s'ils se chevauchent
+    std::vector<SDL_Rect> dirtyRects;
+    for (const auto & cell : _dirtyCells) {
+        if (HexGeometry::axialDistance(cell.first, cell.second) > gridSize) continue;
+
+        const std::pair<int, int> center = HexGeometry::layoutPosition(cell.first, cell.second, x, y, rotation, sinAlpha, hexRadius);
+        const int top = static_cast<int>(std::floor(center.second - hexRadius * sinAlpha)) - margin;
+        const int bottom = static_cast<int>(std::ceil(center.second + hexRadius * sinAlpha + height)) + margin;
+        SDL_Rect rect = {center.first - hexRadius - margin, top, 2 * (hexRadius + margin), bottom - top};
+
+        for (auto it = dirtyRects.begin(); it != dirtyRects.end();) {
+            if (SDL_HasIntersection(&rect, &*it)) {
+                SDL_UnionRect(&rect, &*it, &rect);
+                dirtyRects.erase(it);
+                it = dirtyRects.begin();
+            } else {
+                ++it;
             }
-            lastCoor = currCoor;
         }
+        dirtyRects.push_back(rect);
     }
 
-    std::sort(hexagones.begin(), hexagones.end(), _compareSecondOfPair);
-
-    for(auto hexagone : hexagones){
-        _draw3DHexagon(hexagone.first, hexagone.second, alpha, sinAlpha, rotation, hexRadius);
+    // 3. redessine chaque rectangle : fond puis hexagones qui le touchent, dans l'ordre du peintre
+    const SDL_Color background = ViewConstants::BACKGROUND_COLOR;
+    std::vector<std::pair<int, int>> hexagones;
+    for (const auto & rect : dirtyRects) {
+        SDL_RenderSetClipRect(_renderer, &rect);
+        SDL_SetRenderDrawColor(_renderer, background.r, background.g, background.b, background.a);
+        SDL_RenderFillRect(_renderer, &rect);
+
+        // un prisme touche le rectangle si son centre est à moins d'un rayon (et de sa hauteur) du bord
+        HexGeometry::layoutCellsInRange(rect.x - hexRadius - margin,
+                                        rect.y - hexRadius * sinAlpha - height - margin,
+                                        rect.x + rect.w + hexRadius + margin,
+                                        rect.y + rect.h + hexRadius * sinAlpha + margin,
+                                        x, y, gridSize, rotation, sinAlpha, hexRadius, hexagones);
+        std::sort(hexagones.begin(), hexagones.end(), HexGeometry::compareSecondOfPair);
+        _drawHexagons(hexagones, x, y, alpha, sinAlpha, rotation);
     }
+    SDL_RenderSetClipRect(_renderer, nullptr);
 }
 
-bool View::_isFaceIsometricallyVisible(float y1, float y2, float y) {
-    float faceY = (y1 + y2) / 2;
-    return faceY >= y;
-}
+void View::_drawHexagons(const std::vector<std::pair<int, int>> & hexagones, const float x, const float y, const float alpha, const float sinAlpha, const float rotation) {
+    constexpr int hexRadius = ViewConstants::HEX_RADIUS;
+
+    // position à l'écran des cellules survolée et sélectionnée
+    std::pair<int, int> hovered = {0, 0}, selected = {0, 0};
+    if (_isCellHovered) {
+        hovered = HexGeometry::layoutPosition(_hoveredQ, _hoveredR, x, y, rotation, sinAlpha, hexRadius);
+    }
+    if (_isCellSelected) {
+        selected = HexGeometry::layoutPosition(_selectedQ, _selectedR, x, y, rotation, sinAlpha, hexRadius);
+    }
 
-bool View::_compareSecondOfPair(std::pair<int, int>& first, std::pair<int, int>& second) {
-    return first.second < second.second;
+    for(auto hexagone : hexagones){
+        SDL_Color topColor = ViewConstants::HEX_TOP_COLOR;
+        if (_isCellSelected && hexagone == selected) {
+            topColor = ViewConstants::HEX_SELECTED_COLOR;
+        } else if (_isCellHovered && hexagone == hovered) {
+            topColor = ViewConstants::HEX_HOVERED_COLOR;
+        }
+        _draw3DHexagon(hexagone.first, hexagone.second, alpha, sinAlpha, rotation, hexRadius, topColor);
+    }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include <utility>
+#include <vector>
 
 #include "Model.hpp"
 
@@ -72,6 +74,61 @@ private:
      */
     float _deltaTime;
 
+    /**
+     * Last known mouse position, in window coordinates.
+     */
+    int _mouseX;
+    int _mouseY;
+    /**
+     * true once the mouse moved over the window, false after it left.
+     */
+    bool _isMousePositionKnown;
+    /**
+     * true if the mouse moved or clicked since the last pick.
+     * Mouse events are coalesced so at most one pick is done per frame.
+     */
+    bool _isPickPending;
+    /**
+     * true if a click is waiting for the next pick.
+     */
+    bool _isClickPending;
+
+    /**
+     * Cell under the mouse, in axial coordinates, valid if _isCellHovered.
+     */
+    bool _isCellHovered;
+    int _hoveredQ;
+    int _hoveredR;
+    /**
+     * Last clicked cell, in axial coordinates, valid if _isCellSelected.
+     */
+    bool _isCellSelected;
+    int _selectedQ;
+    int _selectedR;
+
+    /**
+     * Render target keeping the last frame for partial redraws, nullptr if unsupported.
+     */
+    SDL_Texture * _frameTexture;
+    /**
+     * true if only the dirty cells are redrawn into _frameTexture, toggled with P.
+     */
+    bool _isPartialRedrawEnabled;
+    /**
+     * true if _frameTexture must be redrawn entirely on the next frame.
+     */
+    bool _isFullRedrawNeeded;
+    /**
+     * Cells, in axial coordinates, whose look changed since the last frame.
+     */
+    std::vector<std::pair<int, int>> _dirtyCells;
+    /**
+     * Model values of the last frame, any change moves the whole grid.
+     */
+    float _lastIsoAlpha;
+    float _lastRotation;
+    int _lastGridSize;
+
     /**
      * @brief Handle key press events.
      *
@@ -82,6 +139,38 @@ private:
      */
     bool _handleKeyPress(SDL_Keycode keyCode, float deltaTime);
 
+    /**
+     * @brief (Re)create _frameTexture, disabling partial redraw if that fails.
+     */
+    void _createFrameTexture(void);
+
+    /**
+     * @brief Store the mouse position of a motion or button event for the next pick.
+     *
+     * @param x The x-coordinate of the mouse.
+     * @param y The y-coordinate of the mouse.
+     * @param isClick true if the event is a left click.
+     */
+    void _handleMouse(int x, int y, bool isClick);
+
+    /**
+     * @brief Forget the mouse position and the hovered cell when the mouse leaves the window.
+     */
+    void _handleMouseLeave(void);
+
+    /**
+     * @brief Pick the cell under the last mouse position and update the hovered (and selected) cell.
+     */
+    void _pickCell(void);
+
+    /**
+     * @brief Check if the isometric angle, the rotation or the grid size changed since the last call.
+     *
+     * @return true if the whole grid must be redrawn.
+     * @return false otherwise.
+     */
+    bool _hasViewChanged(void);
+
     /**
      * Draw the background.
      */
@@ -117,7 +206,18 @@ private:
      */
     void _drawThickRoundLine(float x1, float y1, float x2, float y2, float thickness, SDL_Color color);
 
-    void _draw3DHexagon(const float x, const float y, const float alpha, const float sinAlpha, const float rotation, const int radius);
+    /**
+     * @brief Draw a hexagonal prism.
+     *
+     * @param x The x-coordinate of the center of the top face.
+     * @param y The y-coordinate of the center of the top face.
+     * @param alpha The isometric angle.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param rotation The rotation of the grid.
+     * @param radius The radius of the hexagon.
+     * @param topColor The color of the top face.
+     */
+    void _draw3DHexagon(const float x, const float y, const float alpha, const float sinAlpha, const float rotation, const int radius, const SDL_Color topColor);
 
     /**
      * @brief Draw a grid at the specified coordinates.
@@ -128,23 +228,23 @@ private:
     void _drawGrid(const float x, const float y);
 
     /**
-     * @brief true if the face y1, y2 of the object place at y is visible
+     * @brief Redraw only the screen rectangles covered by the dirty cells.
+     * Each rectangle is cleared then every hexagon overlapping it is redrawn, clipped, in painter's order.
      *
-     * @param y1 height of the first side of the face
-     * @param y2 height of the second side of the face
-     * @param y height if the centre of the object
-     * @return true the face is visible
-     * @return false the face is hide
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
      */
-    bool _isFaceIsometricallyVisible(float y1, float y2, float y);
+    void _drawDirtyCells(const float x, const float y);
 
     /**
-     * @brief Compare the second element of two pairs.
+     * @brief Draw hexagons, already sorted in painter's order, with the hovered and selected cells highlighted.
      *
-     * @param first The first pair to compare.
-     * @param second The second pair to compare.
-     * @return true if the second element of the first pair is less than the second element of the second pair.
-     * @return false otherwise.
+     * @param hexagones The screen positions of the hexagons.
+     * @param x The x-coordinate of the center of the grid.
+     * @param y The y-coordinate of the center of the grid.
+     * @param alpha The isometric angle.
+     * @param sinAlpha The sinus of the isometric angle.
+     * @param rotation The rotation of the grid.
      */
-    static bool _compareSecondOfPair(std::pair<int, int>& first, std::pair<int, int>& second);
+    void _drawHexagons(const std::vector<std::pair<int, int>> & hexagones, const float x, const float y, const float alpha, const float sinAlpha, const float rotation);
 };
\ No newline at end of file
@@ -1,8 +1,18 @@
 #pragma once
+#include <SDL2/SDL.h>
 
 namespace ViewConstants {
     constexpr char WINDOW_TITLE[] = "wave";
     constexpr int WINDOW_WIDTH = 1920;
     constexpr int WINDOW_HEIGHT = 1080;
     constexpr int FRAME_RATE = 60;
+    constexpr int HEX_RADIUS = 30;
+    constexpr SDL_Color BACKGROUND_COLOR = {15, 131, 247, 255};
+    /**
+     * Margin in pixels around the bounds of a prism, for its 1 pixel outlines.
+     */
+    constexpr int DIRTY_RECT_MARGIN = 2;
+    constexpr SDL_Color HEX_TOP_COLOR = {0, 200, 150, 255};
+    constexpr SDL_Color HEX_HOVERED_COLOR = {90, 230, 190, 255};
+    constexpr SDL_Color HEX_SELECTED_COLOR = {240, 200, 60, 255};
 }
\ No newline at end of file